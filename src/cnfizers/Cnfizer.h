@@ -40,6 +40,7 @@ public:
    , solver  ( solver_ )
    , config  ( config_ )
    , sstore  ( sstore_ )
+   , check_count ( 0 )
   { }
 
   virtual ~Cnfizer( ) { }
@@ -53,9 +54,9 @@ public:
 
 protected:
   
-  virtual bool cnfize	       ( Enode *, map< enodeid_t, Enode * > & ) = 0; // Actual cnfization. To be implemented in derived classes
+  virtual bool cnfize	       ( Enode * ) = 0;                              // Actual cnfization. To be implemented in derived classes
   bool         deMorganize     ( Enode * ); 		                     // Apply deMorgan rules whenever feasible
-  Enode *      rewriteMaxArity ( Enode *, map< enodeid_t, int > & );         // Rewrite terms using maximum arity
+  Enode *      rewriteMaxArity ( Enode * );                                  // Rewrite terms using maximum arity
 
   bool  checkCnf                   ( Enode * );			             // Check if formula is in CNF
   bool  checkDeMorgan              ( Enode * );                              // Check if formula can be deMorganized
@@ -64,6 +65,7 @@ protected:
   void  retrieveTopLevelFormulae   ( Enode *, vector< Enode * > & );         // Retrieves the list of top-level formulae
   void  retrieveClause             ( Enode *, vector< Enode * > & );         // Retrieve a clause from a formula
   void  retrieveConjuncts          ( Enode *, vector< Enode * > & );         // Retrieve the list of conjuncts
+  void  retrieveFlattenedArgs      ( Enode *, vector< Enode * > & );         // Retrieve arguments of nested applications of the same operator
                                                                              
   Enode * toggleLit		   ( Enode * );                              // Handy function for toggling literals
                                                                              
@@ -77,14 +79,24 @@ protected:
 
 private:
 
-  void    computeIncomingEdges ( Enode *, map< enodeid_t, int > & );         // Computes the list of incoming edges for a node
-  Enode * mergeEnodeArgs       ( Enode *
-                               , map< enodeid_t, Enode * > &
-                               , map< enodeid_t, int > & );                  // Subroutine for rewriteMaxArity
-
-  bool    checkConj            ( Enode *, set< enodeid_t > & );              // Check if a formula is a conjunction
-  bool    checkClause          ( Enode *, set< enodeid_t > & );              // Check if a formula is a clause
-  bool    checkPureConj        ( Enode *, set< enodeid_t > & );              // Check if a formula is purely a conjuntion
+  void    computeIncomingEdges ( Enode * );                                  // Computes the list of incoming edges for a node
+  Enode * mergeEnodeArgs       ( Enode * );                                  // Subroutine for rewriteMaxArity
+  void    clearMaxArityTables  ( );                                          // Reset the tables used by rewriteMaxArity
+
+  bool    checkPureConj        ( Enode * );                                  // Check if a formula is purely a conjuntion
+  void    newCheck             ( );                                          // Start a new visit for the check routines
+  bool    isChecked            ( Enode * );                                  // Has the enode been visited by the current check ?
+  void    setChecked           ( Enode * );                                  // Mark the enode as visited by the current check
+
+  //
+  // The tables below are indexed by enode id, and are kept
+  // across calls so that they are allocated only once
+  //
+  vector< int >       incoming_edges;                                        // Number of incoming edges, 0 if not visited
+  vector< Enode * >   max_arity_cache;                                       // Rewritten enode, NULL if not visited
+  vector< enodeid_t > max_arity_touched;                                     // Ids to clear once a conjunct is done
+  vector< unsigned >  check_stamp;                                           // Visit marks for the check routines
+  unsigned            check_count;                                           // Current visit mark
 };
 
 #endif
@@ -38,21 +38,34 @@ public:
 
 private:
 
-  bool cnfize           ( Enode *, map< int, Enode * > & );       // Do the actual cnfization
+  //
+  // Directions in which the definition of a subformula
+  // is encoded: pol_pos for def -> subformula, pol_neg 
+  // for subformula -> def
+  //
+  enum { pol_none = 0, pol_pos = 1, pol_neg = 2, pol_both = 3 };
+
+  bool cnfize                    ( Enode * );                      // Do the actual cnfization
+  void computeEncodingDirections ( Enode * );                      // Compute the directions needed by each subformula
+  char missingDirections         ( Enode * );                      // Directions still to encode for a subformula
 #ifdef PRODUCE_PROOF
-  void cnfizeAnd        ( Enode *, Enode *, const uint64_t = 0 ); // Cnfize conjunctions
-  void cnfizeOr         ( Enode *, Enode *, const uint64_t = 0 ); // Cnfize disjunctions
-  void cnfizeIff        ( Enode *, Enode *, const uint64_t = 0 ); // Cnfize iffs
-  void cnfizeImplies    ( Enode *, Enode *, const uint64_t = 0 ); // Cnfize implies
-  void cnfizeXor        ( Enode *, Enode *, const uint64_t = 0 ); // Cnfize xors
-  void cnfizeIfthenelse ( Enode *, Enode *, const uint64_t = 0 ); // Cnfize if then elses
+  void cnfizeAnd        ( Enode *, Enode *, const char, const uint64_t = 0 ); // Cnfize conjunctions
+  void cnfizeOr         ( Enode *, Enode *, const char, const uint64_t = 0 ); // Cnfize disjunctions
+  void cnfizeIff        ( Enode *, Enode *, const char, const uint64_t = 0 ); // Cnfize iffs
+  void cnfizeImplies    ( Enode *, Enode *, const uint64_t = 0 );             // Cnfize implies
+  void cnfizeXor        ( Enode *, Enode *, const char, const uint64_t = 0 ); // Cnfize xors
+  void cnfizeIfthenelse ( Enode *, Enode *, const uint64_t = 0 );             // Cnfize if then elses
 #else
-  void cnfizeAnd        ( Enode *, Enode * ); // Cnfize conjunctions
-  void cnfizeOr         ( Enode *, Enode * ); // Cnfize disjunctions
-  void cnfizeIff        ( Enode *, Enode * ); // Cnfize iffs
-  void cnfizeXor        ( Enode *, Enode * ); // Cnfize xors
-  void cnfizeIfthenelse ( Enode *, Enode * ); // Cnfize if then elses
+  void cnfizeAnd        ( Enode *, Enode *, const char ); // Cnfize conjunctions
+  void cnfizeOr         ( Enode *, Enode *, const char ); // Cnfize disjunctions
+  void cnfizeIff        ( Enode *, Enode *, const char ); // Cnfize iffs
+  void cnfizeXor        ( Enode *, Enode *, const char ); // Cnfize xors
+  void cnfizeIfthenelse ( Enode *, Enode * );             // Cnfize if then elses
 #endif
+
+  vector< char >    polarity_required;                     // ENODE_ID --> directions needed in the current formula
+  vector< char >    polarity_encoded;                      // ENODE_ID --> directions encoded by the definition in DupMap1
+  vector< Enode * > polarity_visited;                      // Nodes with polarity_required set
 };
 
 #endif
@@ -20,18 +20,61 @@ Copyright (c) 2008, 2009 Centre national de la recherche scientifique (CNRS)
 #include <stdint.h>
 #include <limits.h>
 
-typedef int32_t  word;
-typedef uint32_t uword;
-typedef int64_t  lword;
-typedef uint64_t ulword;
-#define WORD_MIN  INT_MIN
-#define WORD_MAX  INT_MAX
-#define UWORD_MAX UINT_MAX
+//
+// Words are 64 bits; the intermediate results of the word
+// operations are computed on 128 bits, so that they can not
+// overflow before the final range check
+//
+typedef int64_t           word;
+typedef uint64_t          uword;
+typedef __int128          lword;
+typedef unsigned __int128 ulword;
+#define WORD_MIN  INT64_MIN
+#define WORD_MAX  INT64_MAX
+#define UWORD_MAX UINT64_MAX
 
 static inline size_t djb2(size_t a, size_t b) {
   return (a << 5) + a + b;
 }
 
+//
+// Conversions between mpz and words. Only values whose absolute
+// value is below 2^63 are kept in words, so that the negation of
+// a word never overflows
+//
+static inline bool mpzFitsWord(mpz_srcptr z) {
+  return mpz_sizeinbase(z, 2) < 64;
+}
+
+#if LONG_MAX >= INT64_MAX
+static inline word mpzGetWord(mpz_srcptr z) {
+  return mpz_get_si(z);
+}
+
+static inline void mpzSetWord(mpz_ptr z, word x) {
+  mpz_set_si(z, x);
+}
+
+static inline void mpzSetUword(mpz_ptr z, uword x) {
+  mpz_set_ui(z, x);
+}
+#else
+static inline word mpzGetWord(mpz_srcptr z) {
+  uword m = 0;
+  mpz_export(&m, NULL, -1, sizeof(m), 0, 0, z);
+  return mpz_sgn(z) < 0 ? -word(m) : word(m);
+}
+
+static inline void mpzSetUword(mpz_ptr z, uword x) {
+  mpz_import(z, 1, -1, sizeof(x), 0, 0, &x);
+}
+
+static inline void mpzSetWord(mpz_ptr z, word x) {
+  mpzSetUword(z, x < 0 ? -uword(x) : uword(x));
+  if (x < 0) mpz_neg(z, z);
+}
+#endif
+
 class FastInteger {
   bool has_mpz, has_word;
   word num;
@@ -49,7 +92,7 @@ class FastInteger {
       assert(has_word);
       mpz_init(mpz);
       has_mpz=true;
-      mpz_set_si(mpz, num);
+      mpzSetWord(mpz, num);
     }
   }
 
@@ -65,8 +108,8 @@ class FastInteger {
   }
 
   void make_word() {
-    if (mpz_fits_sint_p(mpz)) {
-      num = mpz_get_si(mpz);
+    if (mpzFitsWord(mpz)) {
+      num = mpzGetWord(mpz);
       has_word = true;
     } else {
       has_word = false;
@@ -99,6 +142,10 @@ public:
   FastInteger(word x) : has_mpz(false), has_word(true), num(x) {
   }
 
+  // Needed to keep 0 from being taken for a null string
+  FastInteger(int x) : has_mpz(false), has_word(true), num(x) {
+  }
+
   friend void inline addition      (FastInteger & dst, const FastInteger & a, const FastInteger & b);
   friend void inline subtraction   (FastInteger & dst, const FastInteger & a, const FastInteger & b);
   friend void inline multiplication(FastInteger & dst, const FastInteger & a, const FastInteger & b);
@@ -260,7 +307,17 @@ public:
 
   FastRational( ) : has_mpq(false), has_word(true), num(0), den(1) { }
 
-  FastRational( word x ) : has_mpq(false), has_word(true), num(x), den(1) { }
+  // Needed to keep 0 from being taken for a null string
+  FastRational( int x ) : has_mpq(false), has_word(true), num(x), den(1) { }
+
+  FastRational( word x ) : has_mpq(false), has_word(true), num(x), den(1)
+  {
+    if ( x == WORD_MIN )
+    {
+      make_mpq( );
+      has_word = false;
+    }
+  }
 
   inline FastRational( const FastRational & );
 
@@ -268,9 +325,9 @@ public:
 
   FastRational( const mpz_class & x )
   {
-    if ( x.fits_sint_p( ) )
+    if ( mpzFitsWord( x.get_mpz_t( ) ) )
     {
-      num = x.get_si( );
+      num = mpzGetWord( x.get_mpz_t( ) );
       den = 1;
       has_word = true;
       has_mpq = false;
@@ -308,8 +365,8 @@ private:
       assert(has_word);
       mpq_init(mpq);
       has_mpq=true;
-      mpz_set_si(mpq_numref(mpq), num);
-      mpz_set_ui(mpq_denref(mpq), den);
+      mpzSetWord(mpq_numref(mpq), num);
+      mpzSetUword(mpq_denref(mpq), den);
     }
   }
 
@@ -333,11 +390,11 @@ private:
   void make_word()
   {
     assert( has_mpq );
-    if ( mpz_fits_sint_p(mpq_numref(mpq))
-      && mpz_fits_uint_p(mpq_denref(mpq)))
+    if ( mpzFitsWord(mpq_numref(mpq))
+      && mpzFitsWord(mpq_denref(mpq)))
     {
-      num = mpz_get_si(mpq_numref(mpq));
-      den = mpz_get_ui(mpq_denref(mpq));
+      num = mpzGetWord(mpq_numref(mpq));
+      den = mpzGetWord(mpq_denref(mpq));
       has_word = true;
     }
     else
@@ -356,6 +413,12 @@ private:
   friend inline void multiplicationAssign( FastRational &, const FastRational & );
   friend inline void divisionAssign      ( FastRational &, const FastRational & );
 
+  friend inline void addMul              ( FastRational &, const FastRational &, const FastRational & );
+  friend inline void subMul              ( FastRational &, const FastRational &, const FastRational & );
+
+  static inline bool addWord             ( word &, uword &, word, uword, word, uword );
+  static inline bool mulWord             ( word &, uword &, word, uword, word, uword );
+
 public:
 
   void print_details ( std::ostream & ) const;
@@ -408,7 +471,7 @@ public:
   inline FastInteger get_den( ) const
   {
     if (has_word)
-      return FastInteger(den);
+      return FastInteger((word)den);
     else
       return FastInteger(mpq_denref(mpq));
   }
@@ -568,7 +631,7 @@ namespace std {
 
 inline void FastInteger::init_read_string(const char *s) {
   errno = 0;
-  num = strtol(s, 0, 10);
+  num = strtoll(s, 0, 10);
   if (errno != ERANGE) {
     has_word = true;
     has_mpz = false;
@@ -580,8 +643,8 @@ inline void FastInteger::init_read_string(const char *s) {
 }
 
 inline FastInteger::FastInteger(const mpz_class& x) {
-  if (mpz_fits_sint_p(x.get_mpz_t())) {
-    num = mpz_get_si(x.get_mpz_t());
+  if (mpzFitsWord(x.get_mpz_t())) {
+    num = mpzGetWord(x.get_mpz_t());
     has_word = true;
     has_mpz = false;
   } else {
@@ -592,8 +655,8 @@ inline FastInteger::FastInteger(const mpz_class& x) {
 }
 
 inline FastInteger::FastInteger(const mpz_t x) {
-  if (mpz_fits_sint_p(x)) {
-    num = mpz_get_si(x);
+  if (mpzFitsWord(x)) {
+    num = mpzGetWord(x);
     has_word = true;
     has_mpz = false;
   } else {
@@ -674,13 +737,13 @@ inline int FastInteger::sign() const {
 }
 
 inline FastRational::FastRational(const FastInteger& x) {
-  if (x.has_word) {
+  if (x.has_word && x.num != WORD_MIN) {
     num = x.num;
     den = 1;
     has_word = true;
     has_mpq = false;
   } else {
-    assert(x.has_mpz);
+    x.force_make_mpz();
     has_word = false;
     has_mpq = true;
     mpq_init(mpq);
@@ -776,75 +839,45 @@ inline ulword absVal(lword x) {
   return x>=0 ? x : -x;
 }
 
-#ifdef FAST_GCD
-uword gcd(uword a, uword b);
-ulword gcd(ulword a, ulword b);
-
-#else
-#ifdef BINARY_GCD
-template<typename integer> integer gcd(integer a, integer b) {
-  if(a==0) return b;
-  if(b==0) return a;
-
-  if (a > b) {
-    a = a%b;
-  } else if (a < b) {
-    b = b%a;
-  } else return a;
-
-  if(a==0) return b;
-  if(b==0) return a;
-
-  unsigned shift=0;
-  while((a&1)==0 && (b&1)==0) {
-    a>>=1;
-    b>>=1;
-    shift++;
-  }
-  while((a&1)==0) a>>=1;
-
-  while(b>0) {
-    while((b&1)==0) b>>=1;
-    if (b>a) {
-      b-=a;
-    } else {
-      integer d=a-b;
-      a=b;
-      b=d;
+//
+// Binary gcd on words
+//
+inline uword gcd(uword a, uword b) {
+  if (a==0) return b;
+  if (b==0) return a;
+
+  const int shift = __builtin_ctzll(a | b);
+  a >>= __builtin_ctzll(a);
+  do {
+    b >>= __builtin_ctzll(b);
+    if (a > b) {
+      uword c = a;
+      a = b;
+      b = c;
     }
-  }
+    b -= a;
+  } while (b != 0);
 
-  return a<<shift;
+  return a << shift;
 }
-template<ulword> ulword gcd(ulword a, ulword b);
-template<uword> uword gcd(uword a, uword b);
 
-#else
-template<typename integer> integer gcd(integer a, integer b) {
-  if(a==0) return b;
-  if(b==0) return a;
-
-  if (b > a) {
-    integer c = a;
-    a = b;
-    b = c;
-  }
-  while(true) {
-    integer r = a%b;
-    if (r==0) return b;
+//
+// Euclid's steps on 128 bits until both values fit in a word
+//
+inline ulword gcd(ulword a, ulword b) {
+  while ((a >> 64) != 0 || (b >> 64) != 0) {
+    if (b == 0) return a;
+    ulword r = a%b;
     a = b;
     b = r;
   }
+  return gcd(uword(a), uword(b));
 }
-template<ulword> ulword gcd(ulword a, ulword b);
-template<uword> uword gcd(uword a, uword b);
-#endif
-#endif
 
 #define CHECK_WORD(var, value) \
   do { \
     lword tmp = value; \
-    if (tmp < WORD_MIN/2 || tmp > WORD_MAX/2) { \
+    if (tmp < -lword(WORD_MAX) || tmp > WORD_MAX) { \
       goto overflow; \
     } \
     var = tmp;\
@@ -861,16 +894,12 @@ template<uword> uword gcd(uword a, uword b);
   do { \
     CHECK_POSITIVE(value); \
     ulword tmp = value; \
-    if (tmp > UWORD_MAX) { \
+    if (tmp > ulword(WORD_MAX)) { \
       goto overflow; \
     } \
     var = tmp;\
   } while(0)
 
-#define COMPUTE_WORD(var, value) \
-  word var; CHECK_WORD(var, value)
-#define COMPUTE_UWORD(var, value) \
-  uword var; CHECK_UWORD(var, value)
 
 #define INTEGER_OP(name, op, mpzop) \
 inline void name(FastInteger& dst, const FastInteger& a, const FastInteger& b){ \
@@ -964,41 +993,91 @@ inline FastRational::FastRational(word n, uword d) : has_mpq(false), has_word(tr
   }
 }
 
+//
+// n/d = an/ad + bn/bd on words, with the gcds computed as in
+// Knuth, TAOCP vol. 2, 4.5.1. The operands must be normalized.
+// Returns false if the result does not fit in words
+//
+inline bool FastRational::addWord(word& n, uword& d, word an, uword ad, word bn, uword bd) {
+  if (bn == 0) {
+    n = an;
+    d = ad;
+    return true;
+  }
+  if (an == 0) {
+    n = bn;
+    d = bd;
+    return true;
+  }
+  if (ad == 1 && bd == 1) {
+    word zn;
+    if (__builtin_add_overflow(an, bn, &zn) || zn == WORD_MIN) return false;
+    n = zn;
+    d = 1;
+    return true;
+  }
+
+  const uword common1 = gcd(ad, bd);
+  lword t = lword(an) * (bd / common1) + lword(bn) * (ad / common1);
+  if (t == 0) {
+    n = 0;
+    d = 1;
+    return true;
+  }
+  uword common2 = 1;
+  if (common1 > 1) {
+    ulword at = absVal(t);
+    common2 = gcd(uword((at >> 64) == 0 ? uword(at) % common1 : at % common1), common1);
+    t /= common2;
+  }
+  const ulword zd = ulword(ad / common1) * (bd / common2);
+  if (t < -lword(WORD_MAX) || t > WORD_MAX || zd > ulword(WORD_MAX)) return false;
+  n = word(t);
+  d = uword(zd);
+  return true;
+}
+
+//
+// n/d = an/ad * bn/bd on words. The operands must be normalized.
+// Returns false if the result does not fit in words
+//
+inline bool FastRational::mulWord(word& n, uword& d, word an, uword ad, word bn, uword bd) {
+  if (an == 0 || bn == 0) {
+    n = 0;
+    d = 1;
+    return true;
+  }
+
+  word zn;
+  uword zd;
+  if (ad == 1 && bd == 1) {
+    if (__builtin_mul_overflow(an, bn, &zn) || zn == WORD_MIN) return false;
+    n = zn;
+    d = 1;
+    return true;
+  }
+
+  const word common1 = gcd(absVal(an), bd), common2 = gcd(absVal(bn), ad);
+  if (__builtin_mul_overflow(an / common1, bn / common2, &zn) || zn == WORD_MIN) return false;
+  if (__builtin_mul_overflow(ad / common2, bd / common1, &zd) || zd > uword(WORD_MAX)) return false;
+  n = zn;
+  d = zd;
+  return true;
+}
+
 inline void addition(FastRational& dst, const FastRational& a, const FastRational& b){
   if (a.has_word && b.has_word) {
-    if (b.num == 0) {
-      dst.num = a.num;
-      dst.den = a.den;
-    } else if (a.num == 0) {
-      dst.num = b.num;
-      dst.den = b.den;
-    } else if (b.den == 1) {
-      CHECK_WORD(dst.num, lword(a.num) + lword(b.num)*a.den);
-      dst.den = a.den;
-    } else if (a.den == 1) {
-      CHECK_WORD(dst.num, lword(b.num) + lword(a.num)*b.den);
-      dst.den = b.den;
-    } else {
-      lword n = lword(a.num)*b.den + lword(b.num)*a.den;
-      ulword d = ulword(a.den) * b.den;
-      lword common = gcd(absVal(n), d);
-      word zn;
-      uword zd;
-      if (common > 1) {
-	CHECK_WORD(zn, n/common);
-	CHECK_UWORD(zd, d/common);
-      } else {
-	CHECK_WORD(zn, n);
-	CHECK_UWORD(zd, d);
-      }
+    word zn;
+    uword zd;
+    if (FastRational::addWord(zn, zd, a.num, a.den, b.num, b.den)) {
       dst.num = zn;
       dst.den = zd;
+      dst.has_word = true;
+      dst.kill_mpq();
+      return;
     }
-    dst.kill_mpq();
-    return;
   }
 
- overflow:
   a.force_make_mpq();
   b.force_make_mpq();
   dst.make_erase_mpq();
@@ -1008,39 +1087,17 @@ inline void addition(FastRational& dst, const FastRational& a, const FastRationa
 
 inline void subtraction(FastRational& dst, const FastRational& a, const FastRational& b){
   if (a.has_word && b.has_word) {
-    if (b.num == 0) {
-      dst.num = a.num;
-      dst.den = a.den;
-    } else if (a.num == 0) {
-      dst.num = -b.num;
-      dst.den = b.den;
-    } else if (b.den == 1) {
-      CHECK_WORD(dst.num, lword(a.num) - lword(b.num)*a.den);
-      dst.den = a.den;
-    } else if (a.den == 1) {
-      CHECK_WORD(dst.num, -lword(b.num) + lword(a.num)*b.den);
-      dst.den = b.den;
-    } else {
-      lword n = lword(a.num)*b.den - lword(b.num)*a.den;
-      ulword d = ulword(a.den) * b.den;
-      lword common = gcd(absVal(n), d);
-      word zn;
-      uword zd;
-      if (common > 1) {
-	CHECK_WORD(zn, n/common);
-	CHECK_UWORD(zd, d/common);
-      } else {
-	CHECK_WORD(zn, n);
-	CHECK_UWORD(zd, d);
-      }
+    word zn;
+    uword zd;
+    if (FastRational::addWord(zn, zd, a.num, a.den, -b.num, b.den)) {
       dst.num = zn;
       dst.den = zd;
+      dst.has_word = true;
+      dst.kill_mpq();
+      return;
     }
-    dst.kill_mpq();
-    return;
   }
 
- overflow:
   a.force_make_mpq();
   b.force_make_mpq();
   dst.make_erase_mpq();
@@ -1069,32 +1126,15 @@ inline void multiplication(FastRational& dst, const FastRational& a, const FastR
   if (a.has_word && b.has_word) {
     word zn;
     uword zd;
-    word common1 = gcd(absVal(a.num), b.den), common2 = gcd(a.den, absVal(b.num));
-    lword k1, k2, k3, k4;
-    if (common1 > 1) {
-      k1 = lword(a.num)/common1;
-      k4 = ulword(b.den)/common1;
-    } else {
-      k1 = lword(a.num);
-      k4 = ulword(b.den);
-    }
-    if (common2 > 1) {
-      k2 = lword(b.num)/common2;
-      k3 = ulword(a.den)/common2;
-    } else {
-      k2 = lword(b.num);
-      k3 = ulword(a.den);
+    if (FastRational::mulWord(zn, zd, a.num, a.den, b.num, b.den)) {
+      dst.num = zn;
+      dst.den = zd;
+      dst.has_word = true;
+      dst.kill_mpq();
+      return;
     }
-    CHECK_WORD(zn, k1 * k2);
-    CHECK_UWORD(zd, k3 * k4);
-    dst.num = zn;
-    dst.den = zd;
-    dst.has_word = true;
-    dst.kill_mpq();
-    return;
   }
 
- overflow:
   a.force_make_mpq();
   b.force_make_mpq();
   dst.make_erase_mpq();
@@ -1104,21 +1144,18 @@ inline void multiplication(FastRational& dst, const FastRational& a, const FastR
 
 inline void division(FastRational& dst, const FastRational& a, const FastRational& b){
   if (a.has_word && b.has_word) {
-    word common1 = gcd(absVal(a.num), absVal(b.num));
-    word common2 = gcd(a.den, b.den);
     word zn;
     uword zd;
-    CHECK_WORD(zn, (lword(a.num)/common1) * (b.den/common2));
-    CHECK_UWORD(zd, ulword(absVal(b.num)/common1) * (a.den/common2));
-    dst.num = zn;
-    dst.den = zd;
-    if (b.num < 0) dst.num=-dst.num;
-    dst.has_word = true;
-    dst.kill_mpq();
-    return;
+    // a * 1/b, where 1/b is normalized as well
+    if (FastRational::mulWord(zn, zd, a.num, a.den, b.num < 0 ? -word(b.den) : word(b.den), absVal(b.num))) {
+      dst.num = zn;
+      dst.den = zd;
+      dst.has_word = true;
+      dst.kill_mpq();
+      return;
+    }
   }
 
- overflow:
   a.force_make_mpq();
   b.force_make_mpq();
   dst.make_erase_mpq();
@@ -1137,36 +1174,13 @@ inline double FastRational::get_d() const {
 
 
 inline void additionAssign(FastRational& a, const FastRational& b){
-  if (b.has_word) {
-    if (b.num == 0) return;
-    if (a.has_word) {
-      if (b.den == 1) {
-	CHECK_WORD(a.num, lword(a.num) + lword(b.num)*a.den);
-      } else if (a.num == 0) {
-	a.num = b.num;
-	a.den = b.den;
-      } else {
-	lword n = lword(a.num)*b.den + lword(b.num)*a.den;
-	ulword d = ulword(a.den) * b.den;
-	lword common = gcd(absVal(n), d);
-	word zn;
-	uword zd;
-	if (common > 1) {
-	  CHECK_WORD(zn, n/common);
-	  CHECK_UWORD(zd, d/common);
-	} else {
-	  CHECK_WORD(zn, n);
-	  CHECK_UWORD(zd, d);
-	}
-	a.num = zn;
-	a.den = zd;
-      }
+  if (a.has_word && b.has_word) {
+    if (FastRational::addWord(a.num, a.den, a.num, a.den, b.num, b.den)) {
       a.kill_mpq();
       return;
     }
   }
 
- overflow:
   a.make_mpq();
   b.force_make_mpq();
   mpq_add(a.mpq, a.mpq, b.mpq);
@@ -1175,23 +1189,12 @@ inline void additionAssign(FastRational& a, const FastRational& b){
 
 inline void subtractionAssign(FastRational& a, const FastRational& b){
   if (a.has_word && b.has_word) {
-    uword common = gcd(a.den, b.den);
-    COMPUTE_WORD(n1, lword(a.num) * (b.den / common));
-    COMPUTE_WORD(n2, lword(b.num) * (a.den / common));
-    lword n = lword(n1) - lword(n2);
-    ulword d = ulword(a.den) * (b.den / common);
-    common = gcd(absVal(n), d);
-    word zn;
-    uword zd;
-    CHECK_WORD(zn, n/common);
-    CHECK_UWORD(zd, d/common);
-    a.num = zn;
-    a.den = zd;
-    a.kill_mpq();
-    return;
+    if (FastRational::addWord(a.num, a.den, a.num, a.den, -b.num, b.den)) {
+      a.kill_mpq();
+      return;
+    }
   }
 
- overflow:
   a.make_mpq();
   b.force_make_mpq();
   mpq_sub(a.mpq, a.mpq, b.mpq);
@@ -1200,19 +1203,12 @@ inline void subtractionAssign(FastRational& a, const FastRational& b){
 
 inline void multiplicationAssign(FastRational& a, const FastRational& b){
   if (a.has_word && b.has_word) {
-    word common1 = gcd(absVal(a.num), b.den);
-    word common2 = gcd(a.den, absVal(b.num));
-    word zn;
-    uword zd;
-    CHECK_WORD(zn, lword(a.num/common1) * (b.num/common2));
-    CHECK_UWORD(zd, ulword(a.den/common2) * (b.den/common1));
-    a.num = zn;
-    a.den = zd;
-    a.kill_mpq();
-    return;
+    if (FastRational::mulWord(a.num, a.den, a.num, a.den, b.num, b.den)) {
+      a.kill_mpq();
+      return;
+    }
   }
 
- overflow:
   a.make_mpq();
   b.force_make_mpq();
   mpq_mul(a.mpq, a.mpq, b.mpq);
@@ -1220,42 +1216,68 @@ inline void multiplicationAssign(FastRational& a, const FastRational& b){
 }
 
 inline void divisionAssign(FastRational& a, const FastRational& b){
-
   if (a.has_word && b.has_word) {
-    word common1 = gcd(absVal(a.num), absVal(b.num)),
-         common2 = gcd(a.den, b.den);
-
-    assert( common1 != 0 );
-    assert( common2 != 0 );
-
-    word zn;
-    uword zd;
-    if (b.num < 0) {
-      CHECK_WORD(zn, -lword(a.num/common1) * (b.den/common2));
-    } else {
-      CHECK_WORD(zn,  lword(a.num/common1) * (b.den/common2));
+    assert( b.num != 0 );
+    if (FastRational::mulWord(a.num, a.den, a.num, a.den, b.num < 0 ? -word(b.den) : word(b.den), absVal(b.num))) {
+      a.kill_mpq();
+      return;
     }
-    CHECK_UWORD(zd, ulword(absVal(b.num)/common1) * (a.den/common2));
-    a.den = zd;
-    a.num = zn;
-    a.kill_mpq();
-    return;
   }
 
- overflow:
   a.make_mpq();
   b.force_make_mpq();
   mpq_div(a.mpq, a.mpq, b.mpq);
   a.make_word();
 }
 
+//
+// a += b * c and a -= b * c, the updates of the simplex rows. On words
+// the product is not normalized into a FastRational; otherwise it is
+// computed into a temporary
+//
+inline void addMul(FastRational& a, const FastRational& b, const FastRational& c){
+  if (b.has_word && c.has_word) {
+    word pn;
+    uword pd;
+    if (a.has_word
+     && FastRational::mulWord(pn, pd, b.num, b.den, c.num, c.den)
+     && FastRational::addWord(a.num, a.den, a.num, a.den, pn, pd)) {
+      a.kill_mpq();
+      return;
+    }
+    if (b.num == 0 || c.num == 0) return;
+  }
+
+  FastRational product;
+  multiplication(product, b, c);
+  additionAssign(a, product);
+}
+
+inline void subMul(FastRational& a, const FastRational& b, const FastRational& c){
+  if (b.has_word && c.has_word) {
+    word pn;
+    uword pd;
+    if (a.has_word
+     && FastRational::mulWord(pn, pd, b.num, b.den, c.num, c.den)
+     && FastRational::addWord(a.num, a.den, a.num, a.den, -pn, pd)) {
+      a.kill_mpq();
+      return;
+    }
+    if (b.num == 0 || c.num == 0) return;
+  }
+
+  FastRational product;
+  multiplication(product, b, c);
+  subtractionAssign(a, product);
+}
+
 inline unsigned FastInteger::size() const {
-  if (has_word) return 32;
+  if (has_word) return 64;
   return mpz_sizeinbase(mpz, 2);
 }
 
 inline unsigned FastRational::size() const {
-  if (has_word) return 64;
+  if (has_word) return 128;
   return mpz_sizeinbase(mpq_numref(mpq), 2) +
     mpz_sizeinbase(mpq_denref(mpq), 2);
 }
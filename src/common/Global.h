@@ -228,6 +228,17 @@ typedef uint64_t cgcolor_t;
 
 } // namespace opensmt
 
+#if !FAST_RATIONALS
+// Fused updates a += b * c and a -= b * c (FastRational has its own)
+inline void addMul( opensmt::Real & a, const opensmt::Real & b, const opensmt::Real & c ) { a += b * c; }
+inline void subMul( opensmt::Real & a, const opensmt::Real & b, const opensmt::Real & c ) { a -= b * c; }
+#if USE_GMP
+// Same signatures as the gcd and lcm of FastInteger
+inline void gcd( opensmt::Integer & d, const opensmt::Integer & a, const opensmt::Integer & b ) { mpz_gcd( d.get_mpz_t( ), a.get_mpz_t( ), b.get_mpz_t( ) ); }
+inline void lcm( opensmt::Integer & d, const opensmt::Integer & a, const opensmt::Integer & b ) { mpz_lcm( d.get_mpz_t( ), a.get_mpz_t( ), b.get_mpz_t( ) ); }
+#endif
+#endif
+
 using opensmt::Real;
 using opensmt::Integer;
 using opensmt::enodeid_t;
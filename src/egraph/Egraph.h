@@ -57,6 +57,7 @@ public:
       , theoryInitialized ( false )
       , time_stamp        ( 0 )
       , use_gmp		  ( false )
+      , array_terms_scanned( 0 )
   {
     //
     // Initialize nil key for splay tree
@@ -232,6 +233,9 @@ public:
                                   
   void    printEnodeList          ( ostream & );
   void    addAssertion            ( Enode * );
+  void    pushAssertionScope      ( );
+  void    popAssertionScope       ( );
+  void    resetAssertionScopes    ( );
   void    evaluateTerm            ( Enode *, Real & );
                                   
   void          initializeStore   ( );
@@ -260,6 +264,7 @@ public:
 
   Enode * copyEnodeEtypeTermWithCache   ( Enode *, bool = false );
   Enode * copyEnodeEtypeListWithCache   ( Enode *, bool = false );
+  Enode * mkEnodeEtypeTerm              ( Enode *, Enode * );
 
   inline void         setRescale        ( Real & r ) { rescale_factor = r; rescale_factor_l = atol( r.get_str( ).c_str( ) ); }
   inline const Real & getRescale        ( Real & p ) { (void)p; return rescale_factor; }
@@ -312,6 +317,7 @@ public:
   int     getInterfaceTermsNumber  ( );
   Enode * getInterfaceTerm         ( const int );
   bool    isRootUF                 ( Enode * );
+  void    getModelEij              ( vector< Enode * > & );
   Enode * canonizeDTC              ( Enode *, bool = false );
   // Not used but left there
   bool    isPureUF                 ( Enode * );
@@ -319,6 +325,8 @@ public:
 
 private:
 
+  void    evaluateInterfaceTerm    ( Enode *, Real & );
+
   vector< Enode * > interface_terms;
   // Cache for interface terms
   set< Enode * >    interface_terms_cache;
@@ -333,9 +341,11 @@ public:
   void		      initializeTheorySolvers ( SimpSMTSolver * );          // Attaches ordinary theory solvers
   lbool               inform                  ( Enode * );                  // Inform the solver about the existence of a theory atom
   bool                assertLit               ( Enode *, bool = false );    // Assert a theory literal
+  bool                assertLits              ( vector< Enode * > & );      // Assert a batch of theory literals
   void                pushBacktrackPoint      ( );                          // Push a backtrack point
   void                popBacktrackPoint       ( );                          // Backtrack to last saved point
   Enode *             getDeduction            ( );                          // Return an implied node based on the current state
+  bool                explainDeduction        ( Enode * );                  // Store the reason of a deduction, if it is known without a check
   Enode *             getSuggestion           ( );                          // Return a suggested literal based on the current state
   vector< Enode * > & getConflict             ( bool = false );             // Get explanation
 #ifdef PRODUCE_PROOF
@@ -400,6 +410,8 @@ private:
   Enode * lookupDefine ( const char * );                        // Retrieve a define
   Enode * insertStore  ( const enodeid_t, Enode *, Enode * );   // Insert node into the global store
   void    removeStore  ( Enode * );                             // Remove a node from the global store
+  Enode * simplifyWithUnits ( Enode * );                        // Replace atoms asserted at top-level with their value
+  void    learnUnits        ( Enode * );                        // Record the top-level literals of an assertion
 #ifndef SMTCOMP
   void    evaluateTermRec ( Enode *, Real & );                  // Evaluate node
 #endif
@@ -438,12 +450,16 @@ private:
   vector< Enode * >              index_to_dist;                 // Table distinction index --> enode
   list< Enode * >                assertions;                    // List of assertions
   vector< Enode * >              cache;                         // Cache simplifications
+  vector< lbool >                id_to_unit;                    // Table ENODE_ID --> value of atom asserted at top-level
+  vector< Enode * >              units;                         // Atoms asserted at top-level, in order
+  vector< size_t >               units_lim;                     // Size of units at each push
   Enode *                        top;                           // Top node of the formula
   map< Pair( int ), Enode * >    ext_store;                     // For fast extraction handling
   vector< Enode * >              se_store;                      // For fast sign extension
   vector< int >                  id_to_inc_edges;               // Keeps track of how many edges enter an enode
   bool                           has_ites;                      // True if there is at least one ite
-  set< Enode * >                 variables;                     // List of variables
+  vector< Enode * >              variables;                     // List of variables
+  vector< char >                 id_to_model_var;               // Table ENODE_ID --> is in variables
 #ifndef SMTCOMP
   vector< Pair( Enode * ) >      top_level_substs;              // Keep track of substitutuions in TopLevelProp.C
   bool                           model_computed;                // Has model been computed lately ?
@@ -479,6 +495,10 @@ private:
   void    merge           ( Enode *, Enode * );                 // Merge two nodes
   bool    mergeLoop       ( Enode * );                          // Merge loop
   void	  deduce          ( Enode *, Enode * );                 // Deduce from merging of two nodes
+  void    deduceEq        ( Enode *, Enode * );                 // Deduce watched equalities from merging of two nodes
+  void    deduceNEq       ( Enode *, Enode * );                 // Deduce watched equalities from a disequality
+  void    pushDeduction   ( Enode *, lbool );                   // Store a deduction, if not already known
+  void    explainNEq      ( Enode *, Enode * );                 // Explain why two nodes are unmergable
   void    undoMerge       ( Enode * );                          // Undoes a merge
   void    undoDisequality ( Enode * );                          // Undoes a disequality
   void    undoDistinction ( Enode * );                          // Undoes a distinction
@@ -497,6 +517,8 @@ private:
   Enode *  expNCA               ( Enode *, Enode * );           // Return the nearest common ancestor of x and y
   void     expRemoveExplanation ( );                            // Undoes the effect of expStoreExplanation
   void     expCleanup           ( );                            // Undoes the effect of expExplain
+  bool     expCacheLookup       ( Enode *, Enode * );           // Retrieve a cached explanation for x and y
+  void     expCacheStore        ( Enode *, Enode *, size_t );   // Cache the explanation for x and y
 
   inline const char * logicStr ( logic_t l )
   {
@@ -516,10 +538,21 @@ private:
     return "";
   }
 
+  //
+  // Dense tables indexed by enode id, grown on demand. informed
+  // holds 0 for nodes not informed, 2 + status of inform otherwise
+  //
+  inline bool  isInitialized  ( Enode * e )         { return e->getId( ) < (enodeid_t)initialized.size( ) && initialized[ e->getId( ) ]; }
+  inline void  setInitialized ( Enode * e, bool b ) { if ( e->getId( ) >= (enodeid_t)initialized.size( ) ) initialized.resize( e->getId( ) + 1, 0 ); initialized[ e->getId( ) ] = b; }
+  inline bool  isInformed     ( Enode * e )         { return e->getId( ) < (enodeid_t)informed.size( ) && informed[ e->getId( ) ] != 0; }
+  inline lbool getInformed    ( Enode * e )         { assert( isInformed( e ) ); return toLbool( informed[ e->getId( ) ] - 2 ); }
+  inline void  setInformed    ( Enode * e, lbool s ) { if ( e->getId( ) >= (enodeid_t)informed.size( ) ) informed.resize( e->getId( ) + 1, 0 ); informed[ e->getId( ) ] = toInt( s ) + 2; }
+
   bool                        theoryInitialized;                // True if theory solvers are initialized
   bool                        state;                            // the hell is this ?
-  set< enodeid_t >            initialized;                      // Keep track of initialized nodes
-  map< enodeid_t, lbool >     informed;                         // Keep track of informed nodes
+  vector< char >              initialized;                      // Keep track of initialized nodes
+  vector< char >              informed;                         // Keep track of informed nodes
+  vector< vector< Enode * > > id_to_eq_watches;                 // Table ENODE_ID --> equality atoms with the node as a side
   vector< Enode * >           pending;                          // Pending merges
   vector< Enode * >           undo_stack_term;                  // Keeps track of terms involved in operations
   vector< oper_t >            undo_stack_oper;                  // Keeps track of operations
@@ -528,6 +561,24 @@ private:
   vector< Enode * >           exp_pending;                      // Pending explanations
   vector< Enode * >           exp_undo_stack;                   // Keep track of exp_parent merges
   vector< Enode * >           exp_cleanup;                      // List of nodes to be restored
+  //
+  // Explanations computed by expExplain( x, y, r ), kept as a
+  // stack. An explanation stays valid until one of the edges of
+  // the explanation tree it uses is removed, i.e. until
+  // exp_undo_stack shrinks below the size it had when computed
+  //
+  struct ExpCacheEntry
+  {
+    Enode * x;                                                  // Node with the smaller id
+    Enode * y;                                                  // Node with the larger id
+    size_t  begin;                                              // Reasons are exp_cache_reasons[ begin, end )
+    size_t  end;
+    size_t  undo_size;                                          // Size of exp_undo_stack when computed
+    int     next;                                               // Previous entry for x, or -1
+  };
+  vector< ExpCacheEntry >     exp_cache;                        // Cached explanations
+  vector< Enode * >           exp_cache_reasons;                // Reasons of cached explanations
+  vector< int >               id_to_exp_cache;                  // Table ENODE_ID --> last cache entry of the node, or -1
   int                         time_stamp;                       // Need for finding NCA
   int                         conf_index;                       // Index of theory solver that caused conflict
 
@@ -542,36 +593,25 @@ private:
 
   //===========================================================================
   // Array Handling routines - Implemented in src/tsolvers/axsolver/AXSolver.C
+  //
+  // Lemmas on demand: read-over-write and extensionality lemmas
+  // are instantiated only on complete models, and only those
+  // that the current model violates
   
-  void              WAxiom				  ( Enode * );
-  void              RoWEqAxiom	                          ( Enode * );
-  void              RoWNeqAxiom	                          ( Enode * );
-  void              WoWEqAxiom	                          ( Enode * );
-  void              WoWNeqAxiom	                          ( Enode * );
-  void              WoRAxiom		                  ( Enode * );
-  void              ExtAxiom		                  ( Enode *, Enode * );
-  void              EqAxiomInst				  ( Enode *, Enode *, Enode * );
-  void              handleArrayAssertedEq                 ( Enode *, Enode * );
-  void              handleArrayAssertedNEq                ( Enode *, Enode * );
-  void              handleArrayAssertedAtomTerm           ( Enode * );
-  void              propagateIndexToArraySubterm          ( Enode * );
-  void              propagateIndexToArraySuperterms       ( Enode * );
-  void              propagateIndexToArrayEquivalenceClass ( Enode *, Enode * );
-  void              handleArrayMerge                      ( Enode *, Enode * );
-  void              addStoreSuperterm                     ( Enode *, Enode * );
-  void              printStoreSupertermsList              ( Enode * );
-  bool              addArrayRelevantIndex                 ( Enode *, Enode *);
-  bool              findArrayRelevantIndex                ( Enode *, Enode *);
-  list< Enode * > & getStoreSupertermsList                ( Enode * );
-  set< Enode * > &  getArrayRelevantIndicesSet            ( Enode * );
-  void              printArrayRelevantIndicesSets         ( Enode * );
-
-  map< enodeid_t, list< Enode * > > storeSuperterms;
-  map< enodeid_t, set< Enode * > >  arrayRelevantIndicesSet;
-
-  //============================================================================
-
-  vector< bool >                 arrayAtomTermDone;
+  void              checkArrays                           ( );                  // Instantiate violated lemmas
+  void              collectArrayTerms                     ( );                  // Collect new selects, stores, array equalities
+  bool              addArrayIndex                         ( Enode *, Enode * ); // Add an index to an array class
+  vector< Enode * > & getArrayIndices                     ( Enode * );          // Indices of an array class
+  bool              RoWEqAxiom                            ( Enode *, Enode * ); // i = j -> R(W(a,i,e),j) = e
+  bool              RoWNeqAxiom                           ( Enode *, Enode * ); // i != j -> R(W(a,i,e),j) = R(a,j)
+  bool              ExtAxiom                              ( Enode *, Enode * ); // a != b -> R(a,i_ab) != R(b,i_ab)
+
+  vector< enodeid_t >            array_selects;                 // Select terms seen so far
+  vector< enodeid_t >            array_stores;                  // Store terms seen so far
+  vector< enodeid_t >            array_eqs;                     // Equalities between arrays seen so far
+  size_t                         array_terms_scanned;           // Enodes already scanned for the above
+  vector< vector< Enode * > >    array_indices;                 // Relevant indices, by root of the array class
+  vector< enodeid_t >            array_indices_roots;           // Roots with non-empty relevant indices
 
 #ifdef BUILD_64
   hash_set< enodeid_pair_t >     clauses_sent;
@@ -244,6 +244,7 @@ public:
   inline lbool    getDecPolarity         ( )       { assert( isAtom( ) && atom_data ); return atom_data->dec_polarity; }
   inline int      getWeightInc           ( )       { assert( isAtom( ) && atom_data ); return atom_data->weight_inc; }
   inline int      getDedIndex            ( ) const { assert( isTerm( ) && atom_data ); return atom_data->ded_index; }
+  inline Enode *  getDedReason           ( ) const { assert( isTerm( ) && atom_data ); return atom_data->ded_reason; }
   inline int      getDistIndex           ( ) const { assert( isTerm( ) && atom_data ); return atom_data->dist_index; }
                   
   inline Enode *  getCb                  ( ) const { assert( isTerm( ) && cong_data && cong_data->term_data ); return cong_data->term_data->cb; }
@@ -282,7 +283,7 @@ public:
   inline void    setExpTimeStamp        ( const int t )          { assert( isTerm( ) && cong_data && cong_data->term_data ); cong_data->term_data->exp_time_stamp = t; }
   inline void    setPolarity            ( const lbool p )        { assert( isTerm( ) && atom_data ); assert( !atom_data->has_polarity ); atom_data->polarity = p; atom_data->has_polarity = true; }
   inline void    resetPolarity          ( )			 { assert( isTerm( ) && atom_data ); assert( atom_data->has_polarity ); atom_data->has_polarity = false; }
-  inline void    setDeduced             ( const lbool d, int i ) { assert( isTerm( ) && atom_data ); assert( !atom_data->is_deduced ); atom_data->deduced = d; atom_data->ded_index = i; atom_data->is_deduced = true; }
+  inline void    setDeduced             ( const lbool d, int i, Enode * r = NULL ) { assert( isTerm( ) && atom_data ); assert( !atom_data->is_deduced ); atom_data->deduced = d; atom_data->ded_index = i; atom_data->ded_reason = r; atom_data->is_deduced = true; }
   inline void    setDeduced             ( const bool s, int i )  { setDeduced( s ? l_False : l_True, i ); }
   inline void    resetDeduced           ( )			 { assert( isTerm( ) && atom_data ); assert( atom_data->is_deduced ); atom_data->is_deduced = false; }
   inline void    setDecPolarity         ( const lbool s )        { assert( isAtom( ) && atom_data ); atom_data->dec_polarity = s; }
@@ -388,7 +389,9 @@ inline const Real Enode::getComplexValue( ) const
 inline void Enode::setValue ( const Real & v )
 {
   assert( isTerm( ) );
-  value = new Real;
+  // Models may be computed several times
+  if ( value == NULL )
+    value = new Real;
   *value = v;
 }
 
@@ -0,0 +1,180 @@
+/*********************************************************************
+Author: Roberto Bruttomesso <roberto.bruttomesso@gmail.com>
+
+OpenSMT -- Copyright (C) 2010, Roberto Bruttomesso
+
+OpenSMT is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenSMT is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenSMT. If not, see <http://www.gnu.org/licenses/>.
+*********************************************************************/
+
+//
+// Bottom-up rewriting of an Enode DAG. Every node is visited once,
+// after its arguments, so a rewrite is linear in the size of the DAG.
+// Results are kept in a cache owned by the rewriter rather than in
+// the egraph DupMaps, so a pass may freely start another rewriter
+// (or use DupMap1/DupMap2) while it is running.
+//
+#ifndef ENODE_REWRITER_H
+#define ENODE_REWRITER_H
+
+#include "Egraph.h"
+
+//
+// A rewriting step applied to each node of the DAG. Passes
+// must be local: they may look at the node being rewritten
+// and at the already rewritten arguments, but not elsewhere
+//
+class RewritePass
+{
+public:
+
+  virtual ~RewritePass( ) { }
+  //
+  // Called before rebuilding enode, with the rewritten
+  // arguments. A non-NULL result replaces the node and
+  // skips the rebuild
+  //
+  virtual Enode * replace ( Enode * enode, Enode * args ) { (void)enode; (void)args; return NULL; }
+  //
+  // Called on the rebuilt (or replaced) node. Returns
+  // the final result for enode
+  //
+  virtual Enode * rewrite ( Enode * enode, Enode * result ) { (void)enode; return result; }
+};
+
+//
+// Runs a sequence of passes in a single traversal. For each
+// node the replace hooks are tried in order until one fires,
+// otherwise the node is rebuilt with the egraph simplifiers;
+// then all the rewrite hooks are applied in order. Fusing
+// passes is only correct if running them one after the other
+// on each node gives the same result as running them one
+// after the other on the whole DAG
+//
+class EnodeRewriter
+{
+public:
+
+  EnodeRewriter( Egraph & egraph_ )
+    : egraph ( egraph_ )
+  { }
+
+  ~EnodeRewriter( ) { }
+
+  inline void addPass ( RewritePass & p ) { passes.push_back( &p ); }
+
+  Enode * rewrite ( Enode * formula )
+  {
+    assert( formula );
+    clearCache( );
+
+    vector< Enode * > unprocessed_enodes;
+    vector< Enode * > new_args;
+    unprocessed_enodes.push_back( formula );
+    //
+    // Visit the DAG of the formula from the leaves to the root
+    //
+    while( !unprocessed_enodes.empty( ) )
+    {
+      Enode * enode = unprocessed_enodes.back( );
+      //
+      // Skip if the node has already been processed before
+      //
+      if ( valCache( enode ) != NULL )
+      {
+	unprocessed_enodes.pop_back( );
+	continue;
+      }
+
+      bool unprocessed_children = false;
+      for ( Enode * arg_list = enode->getCdr( )
+	  ; !arg_list->isEnil( )
+	  ; arg_list = arg_list->getCdr( ) )
+      {
+	Enode * arg = arg_list->getCar( );
+	assert( arg->isTerm( ) );
+	if ( valCache( arg ) == NULL )
+	{
+	  unprocessed_enodes.push_back( arg );
+	  unprocessed_children = true;
+	}
+      }
+
+      if ( unprocessed_children )
+	continue;
+
+      unprocessed_enodes.pop_back( );
+      //
+      // Collect rewritten arguments
+      //
+      new_args.clear( );
+      for ( Enode * arg_list = enode->getCdr( )
+	  ; !arg_list->isEnil( )
+	  ; arg_list = arg_list->getCdr( ) )
+	new_args.push_back( valCache( arg_list->getCar( ) ) );
+
+      Enode * args = const_cast< Enode * >( egraph.enil );
+      for ( size_t i = new_args.size( ) ; i > 0 ; i -- )
+	args = egraph.cons( new_args[ i - 1 ], args );
+
+      Enode * result = NULL;
+      for ( size_t p = 0 ; p < passes.size( ) && result == NULL ; p ++ )
+	result = passes[ p ]->replace( enode, args );
+
+      if ( result == NULL )
+	result = egraph.mkEnodeEtypeTerm( enode, args );
+
+      for ( size_t p = 0 ; p < passes.size( ) ; p ++ )
+	result = passes[ p ]->rewrite( enode, result );
+
+      assert( result );
+      storeCache( enode, result );
+    }
+
+    Enode * new_formula = valCache( formula );
+    assert( new_formula );
+    return new_formula;
+  }
+
+private:
+
+  inline Enode * valCache ( Enode * e )
+  {
+    const size_t id = static_cast< size_t >( e->getId( ) );
+    return id < cache.size( ) ? cache[ id ] : NULL;
+  }
+
+  inline void storeCache ( Enode * e, Enode * r )
+  {
+    const size_t id = static_cast< size_t >( e->getId( ) );
+    if ( id >= cache.size( ) )
+      cache.resize( id + 1, NULL );
+    assert( cache[ id ] == NULL );
+    cache[ id ] = r;
+    touched.push_back( id );
+  }
+
+  inline void clearCache ( )
+  {
+    for ( size_t i = 0 ; i < touched.size( ) ; i ++ )
+      cache[ touched[ i ] ] = NULL;
+    touched.clear( );
+  }
+
+  Egraph &                egraph;  // Reference to egraph
+  vector< RewritePass * > passes;  // Passes, in application order
+  vector< Enode * >       cache;   // Rewritten node, indexed by id
+  vector< size_t >        touched; // Ids set in cache
+};
+
+#endif
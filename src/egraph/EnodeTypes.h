@@ -228,6 +228,7 @@ struct AtomData
     : polarity     ( l_Undef )
     , deduced      ( l_Undef )
     , ded_index    ( -2 )
+    , ded_reason   ( NULL )
     , dist_index   ( -1 )
     , has_polarity ( false )
     , is_deduced   ( false )
@@ -238,6 +239,7 @@ struct AtomData
   lbool   polarity;         // Associated polarity on the trail
   lbool   deduced;          // Associated deduced polarity. l_Undef means not deduced
   int     ded_index;        // Index of the solver that deduced this atom
+  Enode * ded_reason;       // Literal that justifies the deduction, if kept by the solver
   int     dist_index;       // If this node is a distinction, dist_index is the index in dist_classes that refers to this distinction
   bool    has_polarity;     // True if has polarity
   bool    is_deduced;       // True if deduced
@@ -44,6 +44,7 @@ private:
   bool    retrieveSubstitutions           ( Enode *, map< enodeid_t, Enode * > & );
   bool    arithmeticElimination           ( vector< Enode * > &, map< enodeid_t, Enode * > & );
   bool    contains                        ( Enode *, Enode * );
+  bool    contains                        ( Enode *, map< enodeid_t, Enode * > & );
   Enode * substitute                      ( Enode *, map< enodeid_t, Enode * > &, bool & );
   Enode * canonize                        ( Enode * );
 #if NEW_SPLIT
@@ -113,6 +113,7 @@ public:
 
 	vec< Clause * >          axioms;         // List of axioms produced with splitting on demand
 	int                      axioms_checked; // Id of next axiom to be checked
+	vec< Lit >               unit_axioms;    // Unit axioms, to be asserted at level 0
 
 #ifdef PRODUCE_PROOF
 	set< int >               axioms_ids;     // Set of ids for lemmas on demand
@@ -335,6 +336,8 @@ protected:
 	int    restartNextLimit       ( int );         // Next conflict limit for restart
 	Var    generateMoreEij        ( );             // Generate more eij
 	Var    generateNextEij        ( );             // Generate next eij
+	int    generateModelEij       ( );             // Generate the eij the models disagree on
+	Var    newEij                 ( Enode *, Enode *, lbool &, bool & ); // Add eij and its linking clauses
 
 #ifndef SMTCOMP
 	void   dumpCNF                ( );             // Dumps CNF to cnf.smt2
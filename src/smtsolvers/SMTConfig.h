@@ -126,9 +126,11 @@ struct SMTConfig
   int          sat_trade_off;                // Specify trade off
   int          sat_minimize_conflicts;       // Conflict minimization: 0 none, 1 bool only, 2 full
   int          sat_dump_cnf;                 // Dump cnf formula
+  int          sat_polarity_cnf;             // Encode definitions only in the directions required by polarity
   int          sat_dump_rnd_inter;           // Dump random interpolant
-  int          sat_lazy_dtc;                 // Activate dtc
-  int          sat_lazy_dtc_burst;           // % of eij to generate
+  int          sat_lazy_dtc;                 // Activate dtc (1 model-based, 2 enumeration of eij)
+  int          sat_lazy_dtc_burst;           // Number of eij to generate at once with sat_lazy_dtc 2
+  int          sat_batch_assert;             // Give the theory solvers the atoms of a backtrack point at once
   int	       sat_reduce_proof;	     // Enable proof reduction
   int 	       sat_reorder_pivots;	     // Enable pivots reordering for interpolation
   double       sat_ratio_red_time_solv_time; // Reduction time / solving time
@@ -152,15 +154,19 @@ struct SMTConfig
   int          bv_theory_propagation;        // Enable theory propagation
   // DL-Solver related parameters
   int          dl_disable;                   // Disable the solver
-  int          dl_theory_propagation;        // Enable theory propagation
+  int          dl_theory_propagation;        // Enable theory propagation (2 batches it at check)
+  int          dl_propagation_budget;        // Max vertices settled by each propagation SSSP, 0 for no limit
   // LRA-Solver related parameters
   int          lra_disable;                  // Disable the solver
   int          lra_theory_propagation;       // Enable theory propagation
-  int          lra_poly_deduct_size;         // Used to define the size of polynomial to be used for deduction; 0 - no deduction for polynomials
+  int          lra_poly_deduct_size;         // Used to define the size of polynomial to be used for deduction; 0 - no deduction for polynomials, -1 - any size
   int          lra_trade_off;                // Trade-off value for DL preprocessing
   int          lra_gaussian_elim;            // Used to switch on/off Gaussian elimination in LRA
   int          lra_integer_solver;           // Flag to require integer solution for LA problem
   int          lra_check_on_assert;          // Probability (0 to 100) to run check when assert is called
+  int          lra_check_row_bounds;         // Run check on assert when the bounds make a row of the tableau inconsistent
+  int          lra_conflict_min;             // Minimize LRA conflicts with a deletion filter over their bounds
+  int          lra_fraction_free;            // Fraction-free tableau with integer coefficients
 
 private:
 
@@ -47,6 +47,7 @@ public:
     , var_True           ( vt )
     , var_False          ( vf )
     , checked_trail_size ( 0 )
+    , replay_conflict    ( 0 )
     , tatoms             ( 0 )
     , batoms             ( 0 )
     , tatoms_given       ( 0 )
@@ -99,6 +100,8 @@ private:
     return (int)(drand(seed) * size); 
   }
 
+  bool assertBatch                       ( int );                // Assert the atoms in batch
+
   void verifyCallWithExternalTool        ( bool, size_t );
   void verifyExplanationWithExternalTool ( vector< Enode * > & );
   void verifyDeductionWithExternalTool   ( Enode * = NULL );
@@ -123,7 +126,10 @@ private:
   const Var           var_True;                 // To specify constantly true atoms
   const Var           var_False;                // To specify constantly false atoms
   vector< Enode * >   stack;                    // Stacked atoms
+  vector< size_t >    backtrack_points;         // Positions in stack of the theory backtrack points
+  vector< Enode * >   batch;                    // Atoms of the current backtrack point to be asserted
   size_t              checked_trail_size;       // Store last size of the trail checked by the solvers
+  size_t              replay_conflict;          // Backtrack points when replaying atoms found a conflict, 0 if none
 
   int                 tatoms;                   // Tracks theory atoms
   int                 batoms;                   // Tracks boolean atoms
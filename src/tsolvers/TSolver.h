@@ -126,6 +126,7 @@ public:
 
   virtual lbool               inform              ( Enode * )               = 0;  // Inform the solver about the existence of a theory atom
   virtual bool                assertLit           ( Enode *, bool = false ) = 0;  // Assert a theory literal
+  virtual bool                assertLits          ( vector< Enode * > & );        // Assert a batch of theory literals
   virtual void                pushBacktrackPoint  ( )                       = 0;  // Push a backtrack point
   virtual void                popBacktrackPoint   ( )                       = 0;  // Backtrack to last saved point
   virtual bool                check               ( bool )                  = 0;  // Check satisfiability
@@ -144,6 +145,20 @@ protected:
   Enode *                     interpolants;     // Store interpolants
 };
 
+//
+// By default the literals of a batch are asserted one at a
+// time. Solvers that can do better (e.g. postpone the
+// consistency check to the end of the batch) override it.
+// The literals have their polarity set before the call
+//
+inline bool TSolver::assertLits( vector< Enode * > & lits )
+{
+  bool res = true;
+  for ( size_t i = 0 ; i < lits.size( ) && res ; i ++ )
+    res = assertLit( lits[ i ] );
+  return res;
+}
+
 class OrdinaryTSolver : public TSolver
 {
 public:
@@ -167,8 +182,9 @@ public:
   virtual ~OrdinaryTSolver ( )
   { }
 
-  virtual bool belongsToT   ( Enode * ) = 0; // Atom belongs to this theory
-  virtual void computeModel ( )         = 0; // Compute model for variables
+  virtual bool belongsToT       ( Enode * ) = 0;              // Atom belongs to this theory
+  virtual void computeModel     ( )         = 0;              // Compute model for variables
+  virtual bool explainDeduction ( Enode * ) { return false; } // Store the reason of a deduction kept by the solver in explanation
 
 protected:
 
@@ -196,6 +212,7 @@ public:
 
   virtual vector< Enode * > & getConflict    ( bool = false ) = 0; // Return conflict
   virtual Enode *             getDeduction   ( )              = 0; // Return an implied node based on the current state
+  virtual bool                explainDeduction ( Enode * )  = 0; // Store the reason of a deduction, if known without a check
   inline void                 setSolver      ( SimpSMTSolver * s ) { assert( s ); assert( solver == NULL ); solver = s; }
   virtual void                splitOnDemand  ( vector< Enode * > &
                                              , const int )    = 0; // For splitting on demand
@@ -203,6 +220,7 @@ public:
 protected:
 
   vector< OrdinaryTSolver * > tsolvers;            // List of ordinary theory solvers
+  vector< vector< Enode * > > tsolvers_lits;       // Batch of literals for each ordinary solver
 #ifdef STATISTICS
   vector< TSolverStats * >    tsolvers_stats;      // Statistical info for tsolvers
 #endif
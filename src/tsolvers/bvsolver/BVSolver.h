@@ -39,6 +39,7 @@ public:
 
   lbool               inform              ( Enode * );
   bool                assertLit           ( Enode *, bool = false );
+  bool                assertLits          ( vector< Enode * > & );
   void                pushBacktrackPoint  ( );
   void                popBacktrackPoint   ( );
   bool                check               ( bool );
@@ -48,6 +49,7 @@ public:
 private:
 
   vector< Enode * > stack;
+  vector< Enode * > batch;
   BitBlaster *      B;
 };
 
@@ -40,6 +40,7 @@ public:
   lbool inform             ( Enode * );
   bool  check              ( );
   bool  assertLit          ( Enode *, const bool );
+  bool  assertLits         ( vector< Enode * > & );
 
   void pushBacktrackPoint  ( );
   void popBacktrackPoint   ( );
@@ -75,6 +76,14 @@ private:
   // vector< Enode * > & bbUp         ( Enode * );
 
 
+  Enode *  mkAndGate             ( Enode *, Enode * );           // Binary and, normalized
+  Enode *  mkOrGate              ( Enode *, Enode * );           // Binary or, normalized
+  Enode *  mkXorGate             ( Enode *, Enode * );           // Binary xor, normalized
+  Enode *  mkIffGate             ( Enode *, Enode * );           // Binary iff, as a negated xor
+
+  inline bool isComplement       ( Enode * a, Enode * b )        // True if a is (not b) or vice-versa
+  { return ( a->isNot( ) && a->get1st( ) == b ) || ( b->isNot( ) && b->get1st( ) == a ); }
+
   Var      cnfizeAndGiveToSolver ( Enode *, Enode * );           // Cnfize 
   void     cnfizeAnd             ( Enode *, Lit, Enode * );      // Cnfize conjunctions
   void     cnfizeOr              ( Enode *, Lit, Enode * );      // Cnfize disjunctions
@@ -71,6 +71,7 @@ public:
     //
     Var     newVar    (bool polarity = true, bool dvar = true); // Add a new variable with parameters specifying variable mode.
     bool    addClause (vec<Lit>& ps, Enode * e = NULL);         // Add a clause to the solver. NOTE! 'ps' may be shrunk by this method!
+    bool    addUnits  (vec<Lit>& ps, vector< Enode * > & es);  // Add a batch of unit clauses, propagated together
 
     // Solving:
     //
@@ -26,7 +26,6 @@ along with OpenSMT. If not, see <http://www.gnu.org/licenses/>.
 #include <stack>
 #include <list>
 #include <vector>
-#include <ext/hash_map>
 #include <ostream>
 
 /*
@@ -55,31 +54,37 @@ class CostSolver : public OrdinaryTSolver
   struct costfun;
 
   /*
-   * Holds a (incur v c t) predicate in a linked list
-   * The list maintained sorted on c.
+   * Holds a (incur v c t) predicate. While unassigned, pos is
+   * its position in the incurheap of the cost variable
    */
   struct incurnode {
     costfun & fun;
     Enode * atom;
-    incurnode * prev;
-    incurnode * next;
+    size_t pos;
     codomain cost;
     incurnode( costfun & f, Enode * a, const codomain & c )
-      : fun( f ), atom( a ), prev( 0 ), next( 0 ), cost( c ) { }
+      : fun( f ), atom( a ), pos( 0 ), cost( c ) { }
   };
 
   /*
-   * The header for the linked list
+   * Binary max-heap on c of the unassigned incur predicates.
+   * Nodes know their position, so that an assigned node is removed
+   * in O(log n), and put back in O(log n) when backtracking
    */
-  struct incurlist {
-    incurnode * head;
-    incurnode * last;
-    incurlist() : head( 0 ), last( 0 ) {}
+  struct incurheap {
+    std::vector< incurnode * > nodes;
+    inline bool         empty( ) const { return nodes.empty( ); }
+    inline incurnode *  top  ( ) const { assert( !nodes.empty( ) ); return nodes[ 0 ]; }
+    void                insert( incurnode * );
+    void                remove( incurnode * );
+  private:
+    void                up    ( size_t );
+    void                down  ( size_t );
   };
 
   /*
    * Holds all information for a cost variable:
-   *   - All unassigned incur predicates in a sorted linked list
+   *   - All unassigned incur predicates in a heap
    *   - All assigned incur predicates
    *   - The currently incurred cost
    *   - The sum of the unassigned incurrable costs (slack)
@@ -90,7 +95,7 @@ class CostSolver : public OrdinaryTSolver
     Enode * variable;
     typedef std::vector< incurnode * > nodes_t;
     nodes_t assigned;
-    incurlist unassigned;
+    incurheap unassigned;
     codomain incurred;
     codomain slack;
     typedef std::stack< bound > bounds_t;
@@ -99,19 +104,24 @@ class CostSolver : public OrdinaryTSolver
     costfun( Enode * var ) : variable( var ), incurred( 0 ), slack( 0 ) { }
   };
 
-  // Hash function for Enode pointers
-  struct nodehash {
-    size_t operator()( Enode* x ) const
-    {
-      return __gnu_cxx::hash< size_t >()( reinterpret_cast< size_t >( x ) );
-    }
-  };
-
-  typedef __gnu_cxx::hash_map< size_t, costfun * > nodemap_ts;
-  typedef __gnu_cxx::hash_map< Enode *, costfun *, nodehash > nodemap_t;
-  nodemap_t nodemap_;
-  typedef __gnu_cxx::hash_map< Enode *, incurnode *, nodehash > incurmap_t;
-  incurmap_t incurmap_;
+  // Cost function of variables and atoms, and node of incur
+  // atoms, indexed by enode id
+  std::vector< costfun * > nodemap_;
+  std::vector< incurnode * > incurmap_;
+
+  inline costfun * find_fun( Enode * e )
+  {
+    const size_t id = e->getId( );
+    return id < nodemap_.size( ) ? nodemap_[ id ] : 0;
+  }
+
+  inline void set_fun( Enode * e, costfun * fun )
+  {
+    const size_t id = e->getId( );
+    if ( id >= nodemap_.size( ) )
+      nodemap_.resize( id + 1, 0 );
+    nodemap_[ id ] = fun;
+  }
 
   typedef std::list< costfun * > costfuns_t;
   costfuns_t costfuns_;
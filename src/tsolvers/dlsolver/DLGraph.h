@@ -44,6 +44,8 @@ template <class T> struct DLVertex
     , gamma         ( 0 )
     , pi            ( 0 )
     , old_pi        ( 0 ) 
+    , heap_pos      ( -1 )
+    , pi_changed    ( false )
     , dx            ( -1 )
     , dy            ( -1 )
     , dx_relevant   ( false )
@@ -62,6 +64,8 @@ template <class T> struct DLVertex
     , gamma	   ( v->gamma )
     , pi	   ( v->pi )
     , old_pi	   ( v->old_pi ) 
+    , heap_pos	   ( v->heap_pos )
+    , pi_changed   ( v->pi_changed )
     , dx	   ( v->dx )
     , dy           ( v->dy )
     , dx_relevant  ( v->dx_relevant )
@@ -83,14 +87,6 @@ template <class T> struct DLVertex
   inline void setDistFrom( DL_sssp_direction go, T val ) { ( go == DL_sssp_forward ) ? dist_from_src = val : dist_from_dst = val;  }
   inline T &  getDistFrom( DL_sssp_direction go )        { return ( go == DL_sssp_forward ) ? dist_from_src : dist_from_dst; }
 
-  struct gammaGreaterThan
-  {
-    inline bool operator ( )( DLVertex * x, DLVertex * y ) 
-    {
-      return x->gamma > y->gamma;	
-    }
-  };
-
   struct ssspGreaterThan
   {
     ssspGreaterThan( DL_sssp_direction go_ ) : go (go_) { }
@@ -122,6 +118,8 @@ template <class T> struct DLVertex
   T	      gamma;
   T	      pi;
   T	      old_pi;
+  int         heap_pos;   // position in the gamma heap, -1 if not queued
+  bool        pi_changed; // pi was updated by the current cycle check
   T	      dx;
   T	      dy;
   bool        dx_relevant;
@@ -165,8 +163,8 @@ template <class T> struct DLEdge
 
 template <class T> struct DLComplEdges
 {
-  DLComplEdges ( DLEdge<T> * pos_
-	       , DLEdge<T> * neg_ ) 
+  DLComplEdges ( DLEdge<T> * pos_ = NULL
+	       , DLEdge<T> * neg_ = NULL ) 
 	     : pos ( pos_ )
 	     , neg ( neg_ )  
   { }
@@ -217,10 +215,7 @@ public:
     DLGraph( SMTConfig & config_, Egraph & egraph_ ) 
       : Vcnt		   ( 0 ) 
       , Ecnt		   ( 0 )
-      , active_pi_prime	   ( false )
-      , pi_prime_count	   ( 0 )
-      , active_gamma	   ( false )
-      , gamma_count	   ( 0 )
+      , Acnt		   ( 0 )
       , active_rwt	   ( false )
       , rwt_count	   ( 0 )
       , active_dist	   ( false )
@@ -237,6 +232,7 @@ public:
       , dfs_finished_count ( 0 )
       , active_apsp_inf    ( false )
       , apsp_inf_count     ( 0 )
+      , zero_vertex        ( NULL )
       , max_dist_from_src  ( 0 )
       , max_dist_from_dst  ( 0 )
       , max_adj_list_size  ( 0 )
@@ -254,13 +250,10 @@ public:
   typedef __gnu_cxx::SizeTDLEdge< const DLEdge<T> * > HashDLEdge;
   typedef vector< DLEdge<T> * >                       DLPath;
 
-  typedef map< Enode *, DLVertex<T> * >	  Enode2Vertex;
-  typedef map< Enode *, DLComplEdges<T> > Enode2Edge;
 
   inline unsigned getVcnt ( ) const { return Vcnt; }
   inline unsigned getEcnt ( ) const { return Ecnt; }
 
-  inline Enode2Edge &            getEdgeMap        ( ) { return edgeMap; }
   inline vector< AdjList > &     getDAdj           ( ) { return dAdj; }
   inline vector< DLEdge<T> * > & getConflictEdges  ( ) { return conflict_edges; }
   inline DLVertex<T> *           getNegCycleVertex ( ) { return negCycleVertex; }
@@ -282,8 +275,9 @@ public:
   void	      deleteActive  ( Enode * );
   void	      deleteInactive( Enode * );
 
-  inline DLEdge<T> * getOppositePolarityEdge( Enode * c ) { assert( c->hasPolarity( ) );  assert( edgeMap.find( c ) != edgeMap.end( ) );    DLComplEdges<T> edges = edgeMap.find( c )->second;     DLEdge<T> * e = c->getPolarity( ) == l_True ? edges.neg : edges.pos;  assert( e ); return e;  }
-  inline DLEdge<T> * getEdgeWithPolarity    ( Enode * c ) { assert( c->hasPolarity( ) );  assert( edgeMap.find( c ) != edgeMap.end( ) );    DLComplEdges<T> edges = edgeMap.find( c )->second;     DLEdge<T> * e = c->getPolarity( ) == l_True ? edges.pos : edges.neg;  assert( e ); return e;  }
+  inline DLEdge<T> * getOppositePolarityEdge( Enode * c ) { assert( c->hasPolarity( ) );  DLComplEdges<T> & edges = getComplEdges( c );     DLEdge<T> * e = c->getPolarity( ) == l_True ? edges.neg : edges.pos;  assert( e ); return e;  }
+  inline DLEdge<T> * getEdgeWithPolarity    ( Enode * c ) { assert( c->hasPolarity( ) );  DLComplEdges<T> & edges = getComplEdges( c );     DLEdge<T> * e = c->getPolarity( ) == l_True ? edges.pos : edges.neg;  assert( e ); return e;  }
+  inline DLEdge<T> * getDeducedEdge         ( Enode * c ) { assert( c->isDeduced( ) );    DLComplEdges<T> & edges = getComplEdges( c );     DLEdge<T> * e = c->getDeduced( ) == l_True ? edges.pos : edges.neg;   assert( e ); return e;  }
 
   inline void updateDynDegree( DLEdge<T> * e )
   {
@@ -301,7 +295,6 @@ public:
   bool	      dfsVisit( DLEdge<T> * ); 
 
   bool        checkNegCycle    ( Enode *, bool );
-  bool        checkNegCycleDFS ( Enode *, bool );
   void	      findHeavyEdges( Enode * );
   void	      iterateInactive( DLEdge<T> * );
 
@@ -369,17 +362,35 @@ public:
   }
 private:
 
+  //
+  // Vertices are numbered densely in order of creation. The NULL
+  // enode (the zero of bound constraints) has its own vertex
+  //
   inline DLVertex<T> * getDLVertex( Enode * x )   
   {	
-    if ( vertexMap.find( x ) == vertexMap.end( ) )
+    DLVertex<T> ** slot = &zero_vertex;
+    if ( x != NULL )
     {
-      DLVertex<T> * v = new DLVertex<T>( x, vertexMap.size( ) );
-      vertexMap.insert( pair< Enode *, DLVertex<T> *> (x, v) );	
-      vertices.resize( vertexMap.size( ) ); vertices[v->id] = v;
-      return v;
+      const int id = x->getId( );
+      if ( id >= (int)enode_id_to_vertex.size( ) )
+	enode_id_to_vertex.resize( id + 1, NULL );
+      slot = &enode_id_to_vertex[ id ];
+    }
+    if ( *slot == NULL )
+    {
+      *slot = new DLVertex<T>( x, vertices.size( ) );
+      vertices.push_back( *slot );
     }
 
-    return vertexMap.find( x )->second;
+    return *slot;
+  }
+
+  // Edges of an atom that has already been seen by getDLEdge
+  inline DLComplEdges<T> & getComplEdges( Enode * c )
+  {
+    assert( c->getId( ) < (int)enode_id_to_edges.size( ) );
+    assert( enode_id_to_edges[ c->getId( ) ].pos != NULL );
+    return enode_id_to_edges[ c->getId( ) ];
   }
 
   DLComplEdges<T> getDLEdge( Enode * );
@@ -391,17 +402,85 @@ private:
     return weight; 
   }
 
-  // Fast pi prime update check. Cannot be nested!
-  inline void initPiPrime   ( )		        { assert( !active_pi_prime ); active_pi_prime = true; pi_primes.resize( Vcnt, pi_prime_count ); ++ pi_prime_count; }
-  inline void updatePiPrime ( DLVertex<T> * v ) { assert(  active_pi_prime ); assert( v->id < (int)pi_primes.size( ) ); pi_primes[ v->id ] = pi_prime_count; }
-  inline bool isPiPrime     ( DLVertex<T> * v ) { assert(  active_pi_prime ); assert( v->id < (int)pi_primes.size( ) ); return pi_primes[ v->id ] == pi_prime_count; }
-  inline void donePiPrime   ( )		        { assert(  active_pi_prime ); active_pi_prime = false; }
+  //
+  // Indexed min-heap on gamma, used by checkNegCycle.
+  // Each vertex knows its position, so decreasing
+  // gamma is a sift up instead of a linear search
+  //
+  inline void pushGammaHeap( DLVertex<T> * v )
+  {
+    assert( v->heap_pos == -1 );
+    v->heap_pos = vertex_heap.size( );
+    vertex_heap.push_back( v );
+    siftUpGammaHeap( v );
+  }
 
-  // Fast gamma update check. Cannot be nested.
-  inline void initGamma   ( )		      { assert( !active_gamma ); active_gamma = true; gammas.resize( Vcnt, gamma_count ); ++ gamma_count; }
-  inline void readGamma   ( DLVertex<T> * v ) { assert(  active_gamma ); assert( v->id < (int)gammas.size( ) ); gammas[ v->id ] = gamma_count; }
-  inline bool isGammaRead ( DLVertex<T> * v ) { assert(  active_gamma ); assert( v->id < (int)gammas.size( ) ); return gammas[ v->id ] == gamma_count; }
-  inline void doneGamma   ( )		      { assert(  active_gamma ); active_gamma = false; }
+  inline DLVertex<T> * popGammaHeap( )
+  {
+    assert( !vertex_heap.empty( ) );
+    DLVertex<T> * top = vertex_heap.front( );
+    DLVertex<T> * last = vertex_heap.back( );
+    vertex_heap.pop_back( );
+    top->heap_pos = -1;
+    if ( last != top )
+    {
+      vertex_heap[ 0 ] = last;
+      last->heap_pos = 0;
+      siftDownGammaHeap( last );
+    }
+    return top;
+  }
+
+  inline void siftUpGammaHeap( DLVertex<T> * v )
+  {
+    int i = v->heap_pos;
+    while ( i > 0 )
+    {
+      const int p = ( i - 1 ) / 2;
+      if ( !( v->gamma < vertex_heap[ p ]->gamma ) )
+	break;
+      vertex_heap[ i ] = vertex_heap[ p ];
+      vertex_heap[ i ]->heap_pos = i;
+      i = p;
+    }
+    vertex_heap[ i ] = v;
+    v->heap_pos = i;
+  }
+
+  inline void siftDownGammaHeap( DLVertex<T> * v )
+  {
+    const int n = vertex_heap.size( );
+    int i = v->heap_pos;
+    for ( ;; )
+    {
+      int c = 2 * i + 1;
+      if ( c >= n )
+	break;
+      if ( c + 1 < n && vertex_heap[ c + 1 ]->gamma < vertex_heap[ c ]->gamma )
+	c ++;
+      if ( !( vertex_heap[ c ]->gamma < v->gamma ) )
+	break;
+      vertex_heap[ i ] = vertex_heap[ c ];
+      vertex_heap[ i ]->heap_pos = i;
+      i = c;
+    }
+    vertex_heap[ i ] = v;
+    v->heap_pos = i;
+  }
+
+  // Resets gamma, heap position and pi flags after checkNegCycle
+  inline void clearGammaHeap( )
+  {
+    for ( typename vector< DLVertex<T> * >::iterator it = vertex_heap.begin( ); it != vertex_heap.end( ); ++ it )
+    {
+      (*it)->gamma = 0;
+      (*it)->heap_pos = -1;
+    }
+    vertex_heap.clear( );
+    for ( typename vector< DLVertex<T> * >::iterator it = changed_vertices.begin( ); it != changed_vertices.end( ); ++ it )
+      (*it)->pi_changed = false;
+    changed_vertices.clear( );
+  }
 
   // Fast rwt update check. Cannot be nested.
   inline void initRwt     ( )		    { assert( !active_rwt ); active_rwt = true; rwts.resize( Ecnt, rwt_count); rwt_count ++;}
@@ -589,15 +668,8 @@ private:
   
   unsigned Vcnt;
   unsigned Ecnt;
+  unsigned Acnt;                    // Number of atoms with edges
 	
-  bool		active_pi_prime;    // To prevent nested usage
-  vector< int > pi_primes;	    // Fast pi prime update checking
-  int		pi_prime_count;	    // New pi prime token
-
-  bool		active_gamma;	    // To prevent nested usage
-  vector< int > gammas;		    // Fast check if gamma was updated
-  int		gamma_count;	    // New gamma token
-
   bool		active_rwt;	    // To prevent nested usage
   vector< int > rwts;		    // Fast chek if rwt was updated
   int           rwt_count;	    // New rwt token
@@ -632,8 +704,9 @@ private:
   int			  apsp_inf_count;  // Apsp infinity check token
 
 
-  Enode2Vertex          vertexMap;
-  Enode2Edge            edgeMap;
+  vector< DLVertex<T> * >   enode_id_to_vertex; // vertex of a DL variable
+  vector< DLComplEdges<T> > enode_id_to_edges;  // edges of a DL atom
+  DLVertex<T> *             zero_vertex;        // vertex of NULL
   vector< AdjList >     sAdj;	   // adjacency list - static constraint graph
   vector< DLEdge<T> * > sEdges;    // edges - static constraint graph
 
@@ -651,8 +724,8 @@ private:
   vector< DLEdge<T> * > conflict_edges;	// used to explain a conflict
   DLVertex<T> *         negCycleVertex;
 
-  vector< DLVertex<T> * > vertex_heap;
-  vector< DLVertex<T> * > changed_vertices;
+  vector< DLVertex<T> * > vertex_heap;      // indexed min-heap on gamma
+  vector< DLVertex<T> * > changed_vertices; // vertices whose pi was updated
 
   // data structures used in SSSP computations
   vector< DLVertex<T> * > dist_heap;    // min-heap of distances
@@ -37,6 +37,7 @@ public:
           , vector< Enode * > & d
 	  , vector< Enode * > & s )
 	  : OrdinaryTSolver ( i, n, c, e, t, x, d, s )
+	  , propagated_edges( 0 )
   {
     initGraph();
   }
@@ -45,11 +46,13 @@ public:
 
   lbool               inform              ( Enode * );
   bool                assertLit           ( Enode *, bool = false );
+  bool                assertLits          ( vector< Enode * > & );
   void                pushBacktrackPoint  ( );
   void                popBacktrackPoint   ( );
   bool                check               ( bool );
   bool                belongsToT          ( Enode * );
   void                computeModel        ( );
+  bool                explainDeduction    ( Enode * );
 #ifdef PRODUCE_PROOF
   Enode *             getInterpolants( );
 #endif
@@ -63,10 +66,13 @@ private:
   void		      backtrackToInactiveEnodesStackSize( size_t );
   void		      backtrackToDeducedEdgesStackSize  ( size_t );
   void		      sendDeductions                    ( );
+  void		      propagateEdges                    ( );
+  void		      explainNegCycle                   ( );
 
   DLGraph< T > *      G;                         // The graph
   vector< Enode * >   undo_stack_edges;		 // Keeps track of edges present in a graph
   vector< size_t  >   backtrack_points;		 // Keeps track of backtrack points
+  size_t              propagated_edges;		 // Edges of undo_stack_edges already propagated
 };
 
 #endif
@@ -66,6 +66,7 @@ private:
 public:
   Enode * e;             //pointer to original Enode. In case of slack variable points to polynomial
   LARow polynomial;      // elements of the variable polynomial (if variable is basic), list of <id, Real*>
+  Real * basic_coef;     // coefficient of the variable in its own polynomial (if variable is basic). It is -1 unless the Tableau is fraction-free
   LAColumn binded_rows;     // rows a variable is binded to (if it is nonbasic) ,list of <id, Real*>
   bool skip;             //used to skip columns deleted during Gaussian
   VectorBounds all_bounds;// array storage for all bounds of the variable
@@ -42,6 +42,36 @@ private:
     bool bound_type;
   };
 
+  // Structure to keep the activity (min/max value) of a row of the Tableau
+  struct LARowActivity
+  {
+    LARowActivity( ) : up( Delta::ZERO ), lo( Delta::ZERO ), up_inf( 0 ), lo_inf( 0 ), valid( false ), queued( false ) { }
+    Delta up;    // sum of the finite contributions to the maximal activity
+    Delta lo;    // sum of the finite contributions to the minimal activity
+    int up_inf;  // number of infinite contributions to the maximal activity
+    int lo_inf;  // number of infinite contributions to the minimal activity
+    bool valid;  // false if the row has to be recomputed from scratch
+    bool queued; // true if the row is waiting in propagation_queue
+  };
+
+  // Bound asserted within a batch
+  struct LABatchBound
+  {
+    LAVar * v;
+    unsigned it_i;
+    bool bound_type;
+    bool is_reason;
+    // Groups the bounds by term and type, the tightest first
+    bool operator<( const LABatchBound & b ) const
+    {
+      if( v->ID( ) != b.v->ID( ) )
+        return v->ID( ) < b.v->ID( );
+      if( bound_type != b.bound_type )
+        return bound_type < b.bound_type;
+      return bound_type ? it_i < b.it_i : it_i > b.it_i;
+    }
+  };
+
   // Possible internal states of the solver
   typedef enum
   {
@@ -63,16 +93,22 @@ public:
     status = INIT;
     checks_history.push_back(0);
     first_update_after_backtrack = true;
+    elimination_pending = false;
+    fraction_free = config.lra_fraction_free
+                 || config.logic == QF_LIA
+                 || config.logic == QF_UFLIA;
   }
   ~LRASolver( );                                     // destructor
 
   lbool inform            ( Enode * );               // Inform LRA about the existence of this constraint
   bool  check             ( bool );                  // Checks the satisfiability of current constraints
   bool  assertLit         ( Enode *, bool = false ); // Push the constraint into Solver
+  bool  assertLits        ( vector< Enode * > & );   // Push a batch of constraints, checking them together
   void  pushBacktrackPoint( );                       // Push a backtrack point
   void  popBacktrackPoint ( );                       // Backtrack to last saved point
   bool  belongsToT        ( Enode * );               // Checks if Atom belongs to this theory
   void  computeModel      ( );                       // Computes the model into enodes
+  bool  explainDeduction  ( Enode * );               // Gives the bound that implied a deduced bound
 
 protected:
   // vector in which witnesses for unsatisfiability are stored
@@ -89,10 +125,24 @@ protected:
 
 private:
   void doGaussianElimination( );                          // Performs Gaussian elimination of all redundant terms in the Tableau
+  void restoreEliminated( LAVar * );                      // Undoes Gaussian elimination down to the given term
+  void saveHistoryBounds( LAVar *, vector<Delta *> & );   // Saves the bounds of a term referenced by the history
+  void restoreHistoryBounds( LAVar *, vector<Delta *> & );// Points the history back to the saved bounds after a sorting
+  void computeRowModel( LAVar * );                        // Computes the model of a basic term from its row
+  void normalizeRow( LAVar * );                           // Makes the coefficients of a row coprime integers (fraction-free Tableau)
   void update( LAVar *, const Delta & );                  // Updates the bounds after constraint pushing
+  void reapplyUpdates( );                                 // Repeats the updates undone by a restored model
   void pivotAndUpdate( LAVar *, LAVar *, const Delta &);  // Updates the tableau after constraint pushing
   void getConflictingBounds( LAVar *, vector<Enode *> & );// Returns the bounds conflicting with the actual model
-  void refineBounds( );                                   // Compute the bounds for touched polynomials and deduces new bounds from it
+  lbool simplex( LAVar * &, unsigned );                   // Runs the simplex, possibly with a limit on the pivots
+  void minimizeConflict( );                               // Removes unnecessary literals from the explanation
+  void refineBounds( );                                   // Deduces new bounds from the activity of the queued rows
+  void queueRow( int );                                   // Schedules a row for bound propagation
+  void invalidateRow( int );                              // Forces the recomputation of the activity of a row
+  void computeRowActivity( int );                         // Computes the activity of a row from scratch
+  void updateRowActivity( LAVar *, bool, const Delta &, const Delta & ); // Updates the activities after a bound change
+  bool checkRowActivities( LAVar * );                     // Checks that the activities of the rows of a term admit a solution
+  bool checkRowActivity( int );                           // Checks that the activity of a row admits a solution
   inline bool getStatus( );                               // Read the status of the solver in lbool
   inline bool setStatus( LRASolverStatus );               // Sets and return status of the solver
   void initSolver( );                                     // Initializes the solver
@@ -105,14 +155,18 @@ private:
 #endif
 
   bool first_update_after_backtrack;
+  bool elimination_pending;                // True if new rows were informed after the last Gaussian elimination
+  bool fraction_free;                      // True if the rows are kept with integer coefficients
 
   LRASolverStatus status;                  // Internal status of the solver (different from bool)
   VectorLAVar slack_vars;              // Collect slack variables (useful for removal)
   vector<Real *> numbers_pool;             // Collect numbers (useful for removal)
-  vector<LAVarHistory> pushed_constraints; // Keeps history of constraints
-  set<LAVar *> touched_rows;               // Keeps the set of modified rows
+  vector<LAVarHistory> pushed_constraints; // Keeps history of the bounds pushed (backtrack_points holds its sizes)
+  vector<LARowActivity> row_activity;      // Keeps the activity of each row (indexed by basicID)
+  vector<int> propagation_queue;           // Keeps the rows whose activity changed since the last refineBounds
+  vector<LABatchBound> batch_bounds;       // Bounds of the batch being asserted
 
-  vector < LAVar * > removed_by_GaussianElimination;       // Stack of variables removed during Gaussian elimination
+  vector < LAVar * > removed_by_GaussianElimination;       // Trail of variables removed during Gaussian elimination
 
   // Two reloaded output operators
   inline friend ostream & operator <<( ostream & out, LRASolver & solver )